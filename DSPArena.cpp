@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    DSPArena.cpp
+    Created: 19 Oct 2026 10:02:11am
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "DSPArena.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_LINUX
+ #include <sys/mman.h>
+#endif
+
+namespace
+{
+    constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+    char* allocateHugePages(size_t numBytes)
+    {
+       #if JUCE_WINDOWS
+        const auto largePageSize = GetLargePageMinimum();
+        if (largePageSize == 0)
+            return nullptr;
+
+        numBytes = (numBytes + largePageSize - 1) & ~(largePageSize - 1);
+
+        // Fails unless the user holds SeLockMemoryPrivilege, in which case we
+        // just fall back to normal pages.
+        return static_cast<char*> (VirtualAlloc(nullptr, numBytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+       #elif JUCE_LINUX
+        void* memory = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        return memory == MAP_FAILED ? nullptr : static_cast<char*> (memory);
+       #else
+        juce::ignoreUnused(numBytes);
+        return nullptr;
+       #endif
+    }
+
+    void freeHugePages(char* memory, size_t numBytes)
+    {
+       #if JUCE_WINDOWS
+        juce::ignoreUnused(numBytes);
+        VirtualFree(memory, 0, MEM_RELEASE);
+       #elif JUCE_LINUX
+        munmap(memory, numBytes);
+       #else
+        juce::ignoreUnused(memory, numBytes);
+       #endif
+    }
+
+    char* allocateAligned(size_t numBytes, size_t alignment)
+    {
+       #if JUCE_WINDOWS
+        return static_cast<char*> (_aligned_malloc(numBytes, alignment));
+       #else
+        void* memory = nullptr;
+        return posix_memalign(&memory, alignment, numBytes) == 0 ? static_cast<char*> (memory) : nullptr;
+       #endif
+    }
+
+    void freeAligned(char* memory)
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(memory);
+       #else
+        free(memory);
+       #endif
+    }
+}
+
+alex_dsp::DSPArena::~DSPArena()
+{
+    release();
+}
+
+void alex_dsp::DSPArena::clear()
+{
+    release();
+    m_footprint = 0;
+}
+
+bool alex_dsp::DSPArena::allocate(bool tryHugePages)
+{
+    release();
+
+    if (m_footprint == 0)
+        return true;
+
+    if (tryHugePages)
+    {
+        const auto numBytes = (m_footprint + hugePageSize - 1) & ~(hugePageSize - 1);
+
+        if (auto* memory = allocateHugePages(numBytes))
+        {
+            m_memory = memory;
+            m_allocatedSize = numBytes;
+            m_usingHugePages = true;
+        }
+    }
+
+    if (m_memory == nullptr)
+    {
+        m_memory = allocateAligned(m_footprint, cacheLineSize);
+        m_allocatedSize = m_footprint;
+        m_usingHugePages = false;
+    }
+
+    if (m_memory == nullptr)
+    {
+        m_allocatedSize = 0;
+        return false;
+    }
+
+    std::memset(m_memory, 0, m_allocatedSize);
+    return true;
+}
+
+void alex_dsp::DSPArena::release()
+{
+    if (m_memory == nullptr)
+        return;
+
+    if (m_usingHugePages)
+        freeHugePages(m_memory, m_allocatedSize);
+    else
+        freeAligned(m_memory);
+
+    m_memory = nullptr;
+    m_allocatedSize = 0;
+    m_usingHugePages = false;
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    DSPArena.h
+    Created: 19 Oct 2026 10:02:11am
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace alex_dsp
+{
+/**
+    One contiguous, cache-line aligned block holding every per-instance DSP
+    buffer and state struct.
+
+    Usage is two-pass: each DSP object first reserve()s the regions it needs
+    and keeps the returned offsets, then allocate() grabs the whole footprint
+    in a single allocation and the objects fetch their pointers with get().
+    Every region starts on its own cache line so no two objects share one.
+*/
+class DSPArena
+{
+public:
+    static constexpr size_t cacheLineSize = 64;
+
+    DSPArena() = default;
+    ~DSPArena();
+
+    /** Forgets the current layout and frees the memory. */
+    void clear();
+
+    /** Reserves room for count objects of type T and returns its byte offset. */
+    template <typename T>
+    size_t reserve(size_t count)
+    {
+        static_assert (std::is_trivially_destructible<T>::value, "Arena storage is never destructed");
+        static_assert (alignof (T) <= cacheLineSize, "Arena regions are only cache-line aligned");
+
+        jassert(m_memory == nullptr); // the layout is fixed once allocated
+
+        const auto offset = m_footprint;
+        m_footprint += roundUpToCacheLine(sizeof (T) * count);
+        return offset;
+    }
+
+    /** Allocates the reserved footprint and zeroes it. Huge pages are tried
+        first when requested, falling back to normal pages if unavailable. */
+    bool allocate(bool tryHugePages);
+
+    /** Frees the memory but keeps the layout, so allocate() can be called again. */
+    void release();
+
+    template <typename T>
+    T* get(size_t offset) const noexcept
+    {
+        jassert(m_memory != nullptr && offset < m_footprint);
+        return reinterpret_cast<T*> (m_memory + offset);
+    }
+
+    bool isAllocated() const noexcept { return m_memory != nullptr; }
+    bool isUsingHugePages() const noexcept { return m_usingHugePages; }
+
+    /** Bytes requested by the layout. */
+    size_t getFootprint() const noexcept { return m_footprint; }
+
+    /** Bytes actually mapped, including huge-page rounding. */
+    size_t getAllocatedSize() const noexcept { return m_allocatedSize; }
+
+private:
+    static size_t roundUpToCacheLine(size_t numBytes) noexcept
+    {
+        return (numBytes + cacheLineSize - 1) & ~(cacheLineSize - 1);
+    }
+
+    char* m_memory{ nullptr };
+    size_t m_footprint{ 0 };
+    size_t m_allocatedSize{ 0 };
+    bool m_usingHugePages{ false };
+
+    JUCE_DECLARE_NON_COPYABLE(DSPArena)
+};
+}
@@ -17,9 +17,10 @@ Distortion<SampleType>::Distortion()
 }
 
 template <typename SampleType>
-void Distortion<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+void Distortion<SampleType>::prepare(juce::dsp::ProcessSpec& spec, const alex_dsp::SharedTables& tables)
 {
     _sampleRate = spec.sampleRate;
+    _tables = &tables;
     reset();
 }
 
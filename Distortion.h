@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "SharedTables.h"
 
 template <typename SampleType>
 class Distortion
@@ -17,7 +18,7 @@ class Distortion
 public:
     Distortion();
 
-    void prepare(juce::dsp::ProcessSpec& spec);
+    void prepare(juce::dsp::ProcessSpec& spec, const alex_dsp::SharedTables& tables);
     void reset();
 
     
@@ -86,7 +87,7 @@ public:
 
     SampleType processSoftClipper(SampleType inputSample)
     {
-        return inputSample;
+        return static_cast<SampleType>(_tables->lookupSaturation(static_cast<float>(inputSample)));
     }
 
     SampleType processSaturation(SampleType inputSample)
@@ -114,5 +115,7 @@ private:
 
     float _sampleRate = 44100.0f;
 
+    const alex_dsp::SharedTables* _tables = nullptr;
+
     DistortionModel _model = DistortionModel::kHard;
 };
@@ -10,12 +10,21 @@
 
 #include "LFOGenerator.h"
 
-void alex_dsp::LFOGenerator::prepare(const juce::dsp::ProcessSpec &spec)
+namespace
 {
+    // computeValue() swings over -outputRange..0.
+    constexpr float outputRange = 10.0f;
+}
+
+void alex_dsp::LFOGenerator::prepare(const juce::dsp::ProcessSpec &spec, const SharedTables& tables)
+{
+    m_tables = &tables;
     m_frequency = 1;
     m_time = 0.0;
     sampleRate = spec.sampleRate;
     m_deltaTime = 1 / sampleRate;
+    m_LFOValue = computeValue(m_time);
+    m_samplesUntilUpdate = 0;
 }
 
 void alex_dsp::LFOGenerator::process()
@@ -34,22 +43,77 @@ void alex_dsp::LFOGenerator::process()
     
     //m_LFOValue = sin(2 * juce::double_Pi * m_frequency * m_time);
 
-    float phase = (m_time * m_frequency) - floor(m_time * m_frequency);
-    m_LFOValue = (2.0f * 10) * (phase < 0.5f ? phase : (1.0f - phase)) - 10;
+    if (m_updateInterval <= 1)
+    {
+        m_LFOValue = computeValue(m_time);
+    }
+    else
+    {
+        if (m_samplesUntilUpdate <= 0)
+        {
+            // Ramp from wherever we are to the value at the last sample of the
+            // segment, so changing the interval never jumps.
+            const float target = computeValue(m_time + (m_updateInterval - 1) * m_deltaTime);
+            m_increment = (target - m_LFOValue) / m_updateInterval;
+            m_samplesUntilUpdate = m_updateInterval;
+        }
+
+        m_LFOValue += m_increment;
+        --m_samplesUntilUpdate;
+    }
 
     m_time += m_deltaTime;
 }
 
+void alex_dsp::LFOGenerator::advance(int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    if (m_GlobalBypass)
+    {
+        m_LFOValue = 0.0;
+        return;
+    }
+
+    if (m_time >= std::numeric_limits<float>::max())
+    {
+        m_time = 0.0;
+    }
+
+    // Land on the value process() would have produced for the last sample,
+    // and start a fresh ramp from there next time.
+    m_LFOValue = computeValue(m_time + (numSamples - 1) * m_deltaTime);
+    m_time += numSamples * m_deltaTime;
+    m_samplesUntilUpdate = 0;
+}
+
+float alex_dsp::LFOGenerator::computeValue(float time) const
+{
+    float phase = (time * m_frequency) - floor(time * m_frequency);
+    return outputRange * m_tables->lookupWavetable(m_shape, phase) - outputRange;
+}
+
 float alex_dsp::LFOGenerator::getCurrentLFOValue()
 {
     return m_LFOValue;
 }
 
+float alex_dsp::LFOGenerator::getNormalisedValue() const
+{
+    if (m_GlobalBypass)
+        return 0.0f;
+
+    return 2.0f * m_LFOValue / outputRange + 1.0f;
+}
+
 void alex_dsp::LFOGenerator::setParameter(ParameterId parameter, float parameterValue)
 {
     switch (parameter)
     {
-    case alex_dsp::LFOGenerator::ParameterId::kFrequency: m_frequency = static_cast<int>(parameterValue); break;
+    case alex_dsp::LFOGenerator::ParameterId::kFrequency: m_frequency = juce::jmax(0.0f, parameterValue); break;
     case alex_dsp::LFOGenerator::ParameterId::kBypass: m_GlobalBypass = static_cast<bool>(parameterValue); break;
+    case alex_dsp::LFOGenerator::ParameterId::kShape: m_shape = static_cast<SharedTables::Wavetable>(juce::jlimit(0, static_cast<int>(SharedTables::Wavetable::kNumWavetables) - 1, static_cast<int>(parameterValue))); break;
+    case alex_dsp::LFOGenerator::ParameterId::kUpdateInterval: m_updateInterval = juce::jmax(1, static_cast<int>(parameterValue)); m_samplesUntilUpdate = 0; break;
     }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "SharedTables.h"
 
 namespace alex_dsp
 {
@@ -17,18 +18,27 @@ class LFOGenerator
 {
 public:
 
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    void prepare(const juce::dsp::ProcessSpec& spec, const SharedTables& tables);
 
     enum class ParameterId
     {
         kFrequency,
         kBypass,
+        kShape,
+        kUpdateInterval,
     };
 
     void LFOGenerator::process();
 
+    /** Same as calling process() numSamples times, for callers that only
+        need the value once per block. */
+    void advance(int numSamples);
+
     float LFOGenerator::getCurrentLFOValue();
 
+    /** The current value mapped to -1..1, or 0 while bypassed. */
+    float getNormalisedValue() const;
+
     void LFOGenerator::setParameter(ParameterId parameter, float parameterValue);
 
 
@@ -36,6 +46,8 @@ public:
 
 private:
 
+    float computeValue(float time) const;
+
     float sampleRate;
 
     float m_frequency;
@@ -43,6 +55,15 @@ private:
     float m_deltaTime;
     float m_GlobalBypass{ false };
     float m_LFOValue;
+
+    const SharedTables* m_tables{ nullptr };
+    SharedTables::Wavetable m_shape{ SharedTables::Wavetable::kTriangle };
+
+    // Above 1 the shape is only evaluated every m_updateInterval samples and
+    // linearly interpolated in between.
+    int m_updateInterval{ 1 };
+    int m_samplesUntilUpdate{ 0 };
+    float m_increment{ 0.0f };
 };
 }
 
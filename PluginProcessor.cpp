@@ -29,6 +29,13 @@ StutterPluginAudioProcessor::StutterPluginAudioProcessor()
     treeState.addParameterListener("mix", this);
     treeState.addParameterListener("output", this);
 
+    treeState.addParameterListener("stutterMode", this);
+    treeState.addParameterListener("stutterDivision", this);
+    treeState.addParameterListener("stutterPitch", this);
+    treeState.addParameterListener("stutterLfoRate", this);
+    treeState.addParameterListener("stutterLfoDepth", this);
+    treeState.addParameterListener("resamplerQuality", this);
+
     //treeState.addParameterListener("lfoType", this);
 
     /*
@@ -50,6 +57,13 @@ StutterPluginAudioProcessor::~StutterPluginAudioProcessor()
     treeState.removeParameterListener("mix", this);
     treeState.removeParameterListener("output", this);
 
+    treeState.removeParameterListener("stutterMode", this);
+    treeState.removeParameterListener("stutterDivision", this);
+    treeState.removeParameterListener("stutterPitch", this);
+    treeState.removeParameterListener("stutterLfoRate", this);
+    treeState.removeParameterListener("stutterLfoDepth", this);
+    treeState.removeParameterListener("resamplerQuality", this);
+
     //treeState.addParameterListener("lfoType", this);
 }
 
@@ -58,6 +72,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout StutterPluginAudioProcessor:
     std::vector <std::unique_ptr<juce::RangedAudioParameter>> params;
 
     juce::StringArray lfoTypes = { "Sine", "Saw", "Square" };
+    juce::StringArray stutterModes = { "Off", "Repeat", "Tape Stop", "Tape Start", "Reverse" };
+    juce::StringArray stutterDivisions = { "1/4", "1/8", "1/16", "1/32" };
+    juce::StringArray resamplerQualities = { "Linear", "Cubic", "Sinc" };
 
 
     auto pWetLevel = std::make_unique<juce::AudioParameterFloat>("wetLevel", "WetLevel", 0.0f, 1.0f, 0.5f);
@@ -66,6 +83,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout StutterPluginAudioProcessor:
     auto pMix = std::make_unique<juce::AudioParameterFloat>("mix", "Mix", 0.0f, 1.0f, 0.0f);
     auto pOutput = std::make_unique<juce::AudioParameterFloat>("output", "Output", -24.0f, 24.0f, 0.0f);
 
+    auto pStutterMode = std::make_unique<juce::AudioParameterChoice>("stutterMode", "Stutter Mode", stutterModes, 0);
+    auto pStutterDivision = std::make_unique<juce::AudioParameterChoice>("stutterDivision", "Stutter Division", stutterDivisions, 2);
+    auto pStutterPitch = std::make_unique<juce::AudioParameterFloat>("stutterPitch", "Stutter Pitch", -12.0f, 12.0f, 0.0f);
+    auto pStutterLfoRate = std::make_unique<juce::AudioParameterFloat>("stutterLfoRate", "Stutter LFO Rate", 0.0f, 8.0f, 1.0f);
+    auto pStutterLfoDepth = std::make_unique<juce::AudioParameterFloat>("stutterLfoDepth", "Stutter LFO Depth", 0.0f, 12.0f, 0.0f);
+    auto pResamplerQuality = std::make_unique<juce::AudioParameterChoice>("resamplerQuality", "Resampler Quality", resamplerQualities, 2);
+
     //auto pLFOType = std::make_unique<juce::AudioParameterChoice>("lfoType", "LFO Type", lfoTypes, 0);
     
     params.push_back(std::move(pWetLevel));
@@ -74,6 +98,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout StutterPluginAudioProcessor:
     params.push_back(std::move(pMix));
     params.push_back(std::move(pOutput));
 
+    params.push_back(std::move(pStutterMode));
+    params.push_back(std::move(pStutterDivision));
+    params.push_back(std::move(pStutterPitch));
+    params.push_back(std::move(pStutterLfoRate));
+    params.push_back(std::move(pStutterLfoDepth));
+    params.push_back(std::move(pResamplerQuality));
+
     //params.push_back(std::move(pLFOType));
     
 
@@ -119,6 +150,16 @@ void StutterPluginAudioProcessor::updateParameters()
     distortion.setDrive(treeState.getRawParameterValue("drive")->load());
     distortion.setMix(treeState.getRawParameterValue("mix")->load());
     distortion.setOutput(treeState.getRawParameterValue("output")->load());
+
+    // Divisions are 1/4 down to 1/32, i.e. 1, 0.5, 0.25 and 0.125 beats.
+    const auto division = static_cast<int>(treeState.getRawParameterValue("stutterDivision")->load());
+    stutter.setParameter(alex_dsp::Stutter::ParameterId::kMode, treeState.getRawParameterValue("stutterMode")->load());
+    stutter.setParameter(alex_dsp::Stutter::ParameterId::kDivision, 1.0f / static_cast<float>(1 << division));
+    stutter.setParameter(alex_dsp::Stutter::ParameterId::kPitch, treeState.getRawParameterValue("stutterPitch")->load());
+    stutter.setParameter(alex_dsp::Stutter::ParameterId::kQuality, treeState.getRawParameterValue("resamplerQuality")->load());
+
+    stutterLfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kFrequency, treeState.getRawParameterValue("stutterLfoRate")->load());
+    stutterLfoDepth = treeState.getRawParameterValue("stutterLfoDepth")->load();
 }
 
 //==============================================================================
@@ -191,22 +232,95 @@ void StutterPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPe
     spec.sampleRate = sampleRate;
     spec.numChannels = getTotalNumOutputChannels();
 
+    if (tables == nullptr || tables->getSampleRate() != sampleRate)
+        tables = alex_dsp::SharedTableRegistry::acquire(sampleRate);
+
     distortion.reset();
-    distortion.prepare(spec);
+    distortion.prepare(spec, *tables);
 
-    reverb.reset();
-    reverb.prepare(spec);
+    arena.clear();
+    stutter.reserve(arena, *tables, spec);
+    reverb.reserve(arena, *tables, spec);
 
-    lfo.prepare(spec);
+    if (arena.allocate(useHugePages))
+    {
+        stutter.attach(arena);
+        reverb.attach(arena);
+    }
+
+    DBG("DSP arena footprint: " << (int) arena.getFootprint() << " bytes"
+        << (arena.isUsingHugePages() ? " (huge pages)" : ""));
+
+    lfo.prepare(spec, *tables);
     lfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kFrequency, 2);
 
+    stutterLfo.prepare(spec, *tables);
+    stutterLfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kShape, static_cast<float>(alex_dsp::SharedTables::Wavetable::kSine));
+
+    quality.prepare(spec);
+    applyQualityLevel(quality.getLevel());
+
     updateParameters();
+
+#if STUTTER_ENABLE_PROFILING
+    // Only instances that actually get prepared join the trace, so plugin
+    // scans don't leave threads and files behind.
+    profiler.start();
+#endif
 }
 
 void StutterPluginAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    stutter.detach();
+    reverb.detach();
+    arena.release();
+    quality.release();
+}
+
+size_t StutterPluginAudioProcessor::getDSPFootprint() const
+{
+    return arena.getFootprint();
+}
+
+void StutterPluginAudioProcessor::setUseHugePages(bool shouldUseHugePages)
+{
+    useHugePages = shouldUseHugePages;
+}
+
+alex_dsp::QualityController& StutterPluginAudioProcessor::getQualityController()
+{
+    return quality;
+}
+
+#if STUTTER_ENABLE_PROFILING
+const alex_dsp::StageProfiler& StutterPluginAudioProcessor::getProfiler() const
+{
+    return profiler;
+}
+#endif
+
+void StutterPluginAudioProcessor::applyQualityLevel(alex_dsp::QualityController::Level level)
+{
+    switch (level)
+    {
+    case alex_dsp::QualityController::Level::kHigh:
+        reverb.setNumActiveCombs(alex_dsp::Reverb::numCombs);
+        lfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kUpdateInterval, 1);
+        stutter.setParameter(alex_dsp::Stutter::ParameterId::kMaxQuality, static_cast<float>(alex_dsp::Resampler::Quality::kSinc));
+        break;
+    case alex_dsp::QualityController::Level::kMedium:
+        reverb.setNumActiveCombs(6);
+        lfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kUpdateInterval, 4);
+        stutter.setParameter(alex_dsp::Stutter::ParameterId::kMaxQuality, static_cast<float>(alex_dsp::Resampler::Quality::kCubicHermite));
+        break;
+    case alex_dsp::QualityController::Level::kLow:
+        reverb.setNumActiveCombs(4);
+        lfo.setParameter(alex_dsp::LFOGenerator::ParameterId::kUpdateInterval, 16);
+        stutter.setParameter(alex_dsp::Stutter::ParameterId::kMaxQuality, static_cast<float>(alex_dsp::Resampler::Quality::kLinear));
+        break;
+    }
+
+    qualityLevel = level;
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -238,6 +352,9 @@ bool StutterPluginAudioProcessor::isBusesLayoutSupported(const BusesLayout& layo
 void StutterPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    STUTTER_PROFILE_STAGE(profiler, kBlock);
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -246,25 +363,55 @@ void StutterPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
     juce::dsp::AudioBlock<float> block (buffer);
 
+    if (auto* playHead = getPlayHead())
+        if (auto position = playHead->getPosition())
+            if (auto bpm = position->getBpm())
+                stutter.setParameter(alex_dsp::Stutter::ParameterId::kTempo, static_cast<float>(*bpm));
+
+    // The stutter LFO only moves the pitch once per block; the stutter ramps
+    // the speed across the block itself.
+    stutterLfo.advance(buffer.getNumSamples());
+    stutter.setParameter(alex_dsp::Stutter::ParameterId::kPitchModulation, stutterLfoDepth * stutterLfo.getNormalisedValue());
+
+    {
+        STUTTER_PROFILE_STAGE(profiler, kStutter);
+        stutter.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
     parameters.wetLevel = wetLevel;
 
     reverb.setParameters(parameters);
 
-    reverb.process(juce::dsp::ProcessContextReplacing<float>(block));
+    {
+        STUTTER_PROFILE_STAGE(profiler, kReverb);
+        reverb.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
 
-    distortion.process(juce::dsp::ProcessContextReplacing<float>(block));
+    {
+        STUTTER_PROFILE_STAGE(profiler, kDistortion);
+        distortion.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
 
-    for (int ch = 0; ch < block.getNumChannels(); ++ch)
     {
-        float* data = block.getChannelPointer(ch);
-        for (int sample = 0; sample < block.getNumSamples(); ++sample)
+        STUTTER_PROFILE_STAGE(profiler, kLFO);
+
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            lfo.process();
-            data[sample] = buffer.getSample(ch, sample) * lfo.getCurrentLFOValue();
+            float* data = block.getChannelPointer(ch);
+            for (int sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                lfo.process();
+                data[sample] = buffer.getSample(ch, sample) * lfo.getCurrentLFOValue();
 
+            }
         }
     }
-    
+
+    const auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStartTicks);
+    const auto newQualityLevel = quality.update(elapsedSeconds, buffer.getNumSamples(), isNonRealtime());
+
+    if (newQualityLevel != qualityLevel)
+        applyQualityLevel(newQualityLevel);
 
 }
 
@@ -11,6 +11,12 @@
 #include <JuceHeader.h>
 #include "Distortion.h"
 #include "LFOGenerator.h"
+#include "DSPArena.h"
+#include "Reverb.h"
+#include "SharedTables.h"
+#include "QualityController.h"
+#include "StageProfiler.h"
+#include "Stutter.h"
 
 //==============================================================================
 /**
@@ -57,6 +63,21 @@ public:
 
     juce::AudioProcessorValueTreeState treeState;
 
+    //==============================================================================
+    /** Bytes of DSP state held in the arena since the last prepareToPlay. */
+    size_t getDSPFootprint() const;
+
+    /** Takes effect on the next prepareToPlay. */
+    void setUseHugePages(bool shouldUseHugePages);
+
+    /** Thresholds and mode of the CPU-load-adaptive quality scaling. */
+    alex_dsp::QualityController& getQualityController();
+
+#if STUTTER_ENABLE_PROFILING
+    /** Per-stage timing histograms; the trace goes to the temp directory. */
+    const alex_dsp::StageProfiler& getProfiler() const;
+#endif
+
 private:
     //==============================================================================
 
@@ -70,12 +91,29 @@ private:
 
     alex_dsp::LFOGenerator lfo;
 
-    juce::dsp::Reverb reverb;
+    alex_dsp::Stutter stutter;
+    alex_dsp::LFOGenerator stutterLfo;
+    float stutterLfoDepth = 0.0f;
+
+    alex_dsp::Reverb reverb;
+
+    alex_dsp::DSPArena arena;
+    bool useHugePages = false;
+
+    std::shared_ptr<const alex_dsp::SharedTables> tables;
+
+    alex_dsp::QualityController quality;
+    alex_dsp::QualityController::Level qualityLevel = alex_dsp::QualityController::Level::kHigh;
+
+#if STUTTER_ENABLE_PROFILING
+    alex_dsp::StageProfiler profiler;
+#endif
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
     void updateParameters();
+    void applyQualityLevel(alex_dsp::QualityController::Level level);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StutterPluginAudioProcessor)
 };
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    QualityController.cpp
+    Created: 19 Oct 2026 3:47:05pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "QualityController.h"
+
+namespace
+{
+    constexpr double loadSmoothingTime = 0.1;
+
+    // Give a step down time to show up in the measurement before taking another.
+    constexpr double settleTime = 0.25;
+
+    // Load must stay under the up threshold this long before stepping back up.
+    constexpr double recoveryTime = 2.0;
+
+    // Every instance's smoothed load added up, in millionths so instances can
+    // add to it from their audio threads without a lock.
+    std::atomic<juce::int64> processLoad{ 0 };
+    constexpr double processLoadScale = 1.0e6;
+}
+
+alex_dsp::QualityController::~QualityController()
+{
+    release();
+}
+
+void alex_dsp::QualityController::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    release();
+
+    m_sampleRate = spec.sampleRate;
+    m_numCores = static_cast<double> (juce::jmax(1, juce::SystemStats::getNumPhysicalCpus()));
+    m_level.store(Level::kHigh, std::memory_order_relaxed);
+    m_load.store(0.0f, std::memory_order_relaxed);
+    m_secondsBelowUpThreshold = 0.0;
+    m_secondsSinceLastChange = 0.0;
+}
+
+void alex_dsp::QualityController::release() noexcept
+{
+    publishLoad(0.0f);
+    m_processLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+void alex_dsp::QualityController::publishLoad(float load) noexcept
+{
+    const auto published = static_cast<juce::int64> (load * processLoadScale);
+    processLoad.fetch_add(published - m_publishedLoad, std::memory_order_relaxed);
+    m_publishedLoad = published;
+}
+
+void alex_dsp::QualityController::setParameter(ParameterId parameter, float parameterValue)
+{
+    switch (parameter)
+    {
+    case alex_dsp::QualityController::ParameterId::kDownThreshold: m_downThreshold = parameterValue; break;
+    case alex_dsp::QualityController::ParameterId::kUpThreshold: m_upThreshold = parameterValue; break;
+    case alex_dsp::QualityController::ParameterId::kMode: m_mode = static_cast<Mode>(juce::jlimit(0, 2, static_cast<int>(parameterValue))); break;
+    case alex_dsp::QualityController::ParameterId::kLockHighWhenNonRealtime: m_lockHighWhenNonRealtime = static_cast<bool>(parameterValue); break;
+    }
+}
+
+alex_dsp::QualityController::Level alex_dsp::QualityController::update(double elapsedSeconds, int numSamples, bool isNonRealtime) noexcept
+{
+    auto level = m_level.load(std::memory_order_relaxed);
+
+    if (numSamples <= 0 || m_sampleRate <= 0)
+        return level;
+
+    const double blockSeconds = numSamples / m_sampleRate;
+    const float blockLoad = static_cast<float>(elapsedSeconds / blockSeconds);
+
+    auto load = m_load.load(std::memory_order_relaxed);
+    load += static_cast<float>(1.0 - std::exp(-blockSeconds / loadSmoothingTime)) * (blockLoad - load);
+    m_load.store(load, std::memory_order_relaxed);
+    publishLoad(load);
+
+    const auto totalLoad = static_cast<float> (processLoad.load(std::memory_order_relaxed) / processLoadScale / m_numCores);
+    m_processLoad.store(totalLoad, std::memory_order_relaxed);
+
+    // Whichever budget runs out first.
+    const auto effectiveLoad = juce::jmax(load, totalLoad);
+
+    m_secondsSinceLastChange += blockSeconds;
+
+    auto mode = m_mode.load();
+
+    if (isNonRealtime && m_lockHighWhenNonRealtime)
+        mode = Mode::kLockedHigh;
+
+    if (mode == Mode::kLockedHigh || mode == Mode::kLockedLow)
+    {
+        level = mode == Mode::kLockedHigh ? Level::kHigh : Level::kLow;
+        m_secondsBelowUpThreshold = 0.0;
+    }
+    else if (effectiveLoad > m_downThreshold.load())
+    {
+        m_secondsBelowUpThreshold = 0.0;
+
+        if (level != Level::kLow && m_secondsSinceLastChange >= settleTime)
+        {
+            level = static_cast<Level>(static_cast<int>(level) - 1);
+            m_secondsSinceLastChange = 0.0;
+        }
+    }
+    else if (effectiveLoad < m_upThreshold.load())
+    {
+        m_secondsBelowUpThreshold += blockSeconds;
+
+        if (level != Level::kHigh && m_secondsBelowUpThreshold >= recoveryTime)
+        {
+            level = static_cast<Level>(static_cast<int>(level) + 1);
+            m_secondsBelowUpThreshold = 0.0;
+            m_secondsSinceLastChange = 0.0;
+        }
+    }
+    else
+    {
+        m_secondsBelowUpThreshold = 0.0;
+    }
+
+    m_level.store(level, std::memory_order_relaxed);
+    return level;
+}
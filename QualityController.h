@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    QualityController.h
+    Created: 19 Oct 2026 3:47:05pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace alex_dsp
+{
+/**
+    Measures how much of each block's real-time budget processBlock used and
+    picks a quality level from it: steps down as soon as the smoothed load
+    crosses the down threshold, and only steps back up once it has stayed
+    under the (lower) up threshold for a while.
+
+    The load compared with the thresholds is the larger of this instance's
+    own load and the process load: every instance's smoothed load added up
+    and spread over the physical cores. So a session of hundreds of cheap
+    instances backs off together before the host runs out of time, and one
+    expensive instance still backs off on its own.
+
+    update() runs on the audio thread; setParameter(), getLevel() and getLoad()
+    may be called from any thread.
+*/
+class QualityController
+{
+public:
+    enum class Level
+    {
+        kLow,
+        kMedium,
+        kHigh
+    };
+
+    enum class Mode
+    {
+        kAdaptive,
+        kLockedHigh,
+        kLockedLow
+    };
+
+    enum class ParameterId
+    {
+        kDownThreshold,
+        kUpThreshold,
+        kMode,
+        kLockHighWhenNonRealtime,
+    };
+
+    QualityController() = default;
+    ~QualityController();
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    /** Takes this instance's load out of the process total, e.g. when the
+        host stops processing. prepare() puts it back on the next update(). */
+    void release() noexcept;
+
+    void setParameter(ParameterId parameter, float parameterValue);
+
+    /** Feeds in the time the last block took and returns the level to use for the next one. */
+    Level update(double elapsedSeconds, int numSamples, bool isNonRealtime) noexcept;
+
+    Level getLevel() const noexcept { return m_level.load(std::memory_order_relaxed); }
+
+    /** Smoothed fraction of the real-time budget, 1.0 meaning the block took exactly as long as it lasts. */
+    float getLoad() const noexcept { return m_load.load(std::memory_order_relaxed); }
+
+    /** Sum of every instance's load divided by the number of physical cores,
+        as of this instance's last update(). */
+    float getProcessLoad() const noexcept { return m_processLoad.load(std::memory_order_relaxed); }
+
+private:
+    void publishLoad(float load) noexcept;
+
+    double m_sampleRate{ 44100.0 };
+    double m_numCores{ 1.0 };
+
+    std::atomic<float> m_downThreshold{ 0.75f };
+    std::atomic<float> m_upThreshold{ 0.45f };
+    std::atomic<Mode> m_mode{ Mode::kAdaptive };
+    std::atomic<bool> m_lockHighWhenNonRealtime{ true };
+
+    // Written only by update(), read from anywhere.
+    std::atomic<Level> m_level{ Level::kHigh };
+    std::atomic<float> m_load{ 0.0f };
+    std::atomic<float> m_processLoad{ 0.0f };
+
+    // What this instance currently contributes to the process total.
+    juce::int64 m_publishedLoad{ 0 };
+
+    // Tracked in seconds so behaviour doesn't depend on the block size.
+    double m_secondsBelowUpThreshold{ 0.0 };
+    double m_secondsSinceLastChange{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE(QualityController)
+};
+}
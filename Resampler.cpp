@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    Resampler.cpp
+    Created: 19 Oct 2026 7:05:52pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "Resampler.h"
+
+namespace
+{
+    constexpr int sincTaps = alex_dsp::SharedTables::sincTaps;
+    constexpr int sincPhases = alex_dsp::SharedTables::sincPhases;
+    constexpr int sincLeftReach = sincTaps / 2 - 1;
+
+    void processLinear(const float* const* rings, int numChannels, const int* indices, const float* fractions,
+                       float* const* outputs, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float f = fractions[i];
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* x = rings[channel] + indices[i];
+                outputs[channel][i] = x[0] + f * (x[1] - x[0]);
+            }
+        }
+    }
+
+    void processCubicHermite(const float* const* rings, int numChannels, int ringMask, const int* indices, const float* fractions,
+                             float* const* outputs, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int index = (indices[i] - 1) & ringMask;
+            const float f = fractions[i];
+            const float f2 = f * f;
+            const float f3 = f2 * f;
+
+            // Catmull-Rom written as four tap weights, so they are worked out
+            // once per output sample whatever the channel count.
+            const float w0 = -0.5f * f + f2 - 0.5f * f3;
+            const float w1 = 1.0f - 2.5f * f2 + 1.5f * f3;
+            const float w2 = 0.5f * f + 2.0f * f2 - 1.5f * f3;
+            const float w3 = -0.5f * f2 + 0.5f * f3;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* x = rings[channel] + index;
+                outputs[channel][i] = (w0 * x[0] + w1 * x[1]) + (w2 * x[2] + w3 * x[3]);
+            }
+        }
+    }
+
+    void processSinc(const float* table, const float* const* rings, int numChannels, int ringMask, const int* indices, const float* fractions,
+                     float* const* outputs, int numSamples) noexcept
+    {
+        alignas (16) float h[sincTaps];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int index = (indices[i] - sincLeftReach) & ringMask;
+
+            const float phasePosition = fractions[i] * sincPhases;
+            const auto phase = juce::jmin(sincPhases - 1, static_cast<int> (phasePosition));
+            const float phaseFraction = phasePosition - phase;
+
+            const float* h0 = table + phase * sincTaps;
+            const float* h1 = h0 + sincTaps;
+
+            // Interpolate the coefficient row once and share it between channels.
+            for (int k = 0; k < sincTaps; ++k)
+                h[k] = h0[k] + phaseFraction * (h1[k] - h0[k]);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* x = rings[channel] + index;
+
+                // Four independent partial sums, so the inner loop maps straight
+                // onto 4-wide SIMD without needing fast-math reassociation.
+                float sums[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+                for (int k = 0; k < sincTaps; k += 4)
+                    for (int j = 0; j < 4; ++j)
+                        sums[j] += x[k + j] * h[k + j];
+
+                outputs[channel][i] = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            }
+        }
+    }
+}
+
+int alex_dsp::Resampler::getLeftReach(Quality quality) noexcept
+{
+    switch (quality)
+    {
+    case Quality::kLinear: return 0;
+    case Quality::kCubicHermite: return 1;
+    case Quality::kSinc: return sincLeftReach;
+    }
+
+    return sincLeftReach;
+}
+
+int alex_dsp::Resampler::getRightReach(Quality quality) noexcept
+{
+    switch (quality)
+    {
+    case Quality::kLinear: return 1;
+    case Quality::kCubicHermite: return 2;
+    case Quality::kSinc: return sincTaps - sincLeftReach - 1;
+    }
+
+    return sincTaps - sincLeftReach - 1;
+}
+
+void alex_dsp::Resampler::process(Quality quality, const SharedTables& tables, int sincBand,
+                                  const float* const* rings, int numChannels, int ringMask,
+                                  const int* indices, const float* fractions,
+                                  float* const* outputs, int numSamples) noexcept
+{
+    switch (quality)
+    {
+    case Quality::kLinear:
+        processLinear(rings, numChannels, indices, fractions, outputs, numSamples);
+        break;
+    case Quality::kCubicHermite:
+        processCubicHermite(rings, numChannels, ringMask, indices, fractions, outputs, numSamples);
+        break;
+    case Quality::kSinc:
+        processSinc(tables.getSincTable(sincBand), rings, numChannels, ringMask, indices, fractions, outputs, numSamples);
+        break;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    Resampler.h
+    Created: 19 Oct 2026 7:05:52pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SharedTables.h"
+
+namespace alex_dsp
+{
+/**
+    Fractional-delay interpolation out of a power-of-two ring buffer.
+
+    Read positions are worked out once per block (see Stutter) and handed in
+    as integer ring indices plus fractions, so every channel reuses them and
+    the kernels are plain loops over output samples. All channels are read in
+    the same pass, so interpolation coefficients are worked out once per
+    output sample rather than once per channel. Each ring must carry
+    guardSamples copies of its first samples past its end so no kernel ever
+    has to wrap mid-read.
+*/
+class Resampler
+{
+public:
+    enum class Quality
+    {
+        kLinear,
+        kCubicHermite,
+        kSinc
+    };
+
+    static constexpr int guardSamples = SharedTables::sincTaps;
+
+    /** Samples needed before and after the integer read position. */
+    static int getLeftReach(Quality quality) noexcept;
+    static int getRightReach(Quality quality) noexcept;
+
+    /** sincBand picks the anti-aliasing band (see SharedTables::getSincBand)
+        and only matters for kSinc. */
+    static void process(Quality quality, const SharedTables& tables, int sincBand,
+                        const float* const* rings, int numChannels, int ringMask,
+                        const int* indices, const float* fractions,
+                        float* const* outputs, int numSamples) noexcept;
+
+private:
+    Resampler() = delete;
+};
+}
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    Reverb.cpp
+    Created: 19 Oct 2026 10:31:48am
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "Reverb.h"
+
+namespace
+{
+    bool isFrozen(float freezeMode) noexcept { return freezeMode >= 0.5f; }
+
+    constexpr double combFadeTime = 0.05;
+}
+
+alex_dsp::Reverb::Reverb()
+{
+    setParameters(juce::Reverb::Parameters());
+}
+
+void alex_dsp::Reverb::reserve(DSPArena& arena, const SharedTables& tables, const juce::dsp::ProcessSpec& spec)
+{
+    detach();
+
+    jassert(tables.getSampleRate() == spec.sampleRate);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+        {
+            m_combSizes[channel][i] = tables.getCombSize(channel, i);
+            m_combBufferOffsets[channel][i] = arena.reserve<float>(static_cast<size_t> (m_combSizes[channel][i]));
+        }
+
+        for (int i = 0; i < numAllPasses; ++i)
+        {
+            m_allPassSizes[channel][i] = tables.getAllPassSize(channel, i);
+            m_allPassBufferOffsets[channel][i] = arena.reserve<float>(static_cast<size_t> (m_allPassSizes[channel][i]));
+        }
+    }
+
+    m_combStateOffset = arena.reserve<CombState>(maxChannels * numCombs);
+    m_allPassStateOffset = arena.reserve<AllPassState>(maxChannels * numAllPasses);
+
+    const double smoothTime = 0.01;
+    m_damping.reset(spec.sampleRate, smoothTime);
+    m_feedback.reset(spec.sampleRate, smoothTime);
+    m_dryGain.reset(spec.sampleRate, smoothTime);
+    m_wetGain1.reset(spec.sampleRate, smoothTime);
+    m_wetGain2.reset(spec.sampleRate, smoothTime);
+
+    m_combFadeStep = static_cast<float> (1.0 / juce::jmax(1.0, combFadeTime * spec.sampleRate));
+}
+
+void alex_dsp::Reverb::attach(DSPArena& arena)
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+            m_combBuffers[channel][i] = arena.get<float>(m_combBufferOffsets[channel][i]);
+
+        for (int i = 0; i < numAllPasses; ++i)
+            m_allPassBuffers[channel][i] = arena.get<float>(m_allPassBufferOffsets[channel][i]);
+    }
+
+    m_combStates = arena.get<CombState>(m_combStateOffset);
+    m_allPassStates = arena.get<AllPassState>(m_allPassStateOffset);
+
+    // The arena comes back zeroed, which is already the reset state.
+}
+
+void alex_dsp::Reverb::detach()
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+            m_combBuffers[channel][i] = nullptr;
+
+        for (int i = 0; i < numAllPasses; ++i)
+            m_allPassBuffers[channel][i] = nullptr;
+    }
+
+    m_combStates = nullptr;
+    m_allPassStates = nullptr;
+}
+
+void alex_dsp::Reverb::reset()
+{
+    if (! isPrepared()) return;
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+        {
+            juce::FloatVectorOperations::clear(m_combBuffers[channel][i], m_combSizes[channel][i]);
+            m_combStates[channel * numCombs + i] = { 0, 0.0f };
+        }
+
+        for (int i = 0; i < numAllPasses; ++i)
+        {
+            juce::FloatVectorOperations::clear(m_allPassBuffers[channel][i], m_allPassSizes[channel][i]);
+            m_allPassStates[channel * numAllPasses + i] = { 0 };
+        }
+    }
+}
+
+void alex_dsp::Reverb::setParameters(const juce::Reverb::Parameters& newParameters)
+{
+    const float wetScaleFactor = 3.0f;
+    const float dryScaleFactor = 2.0f;
+
+    const float wet = newParameters.wetLevel * wetScaleFactor;
+    m_dryGain.setTargetValue(newParameters.dryLevel * dryScaleFactor);
+    m_wetGain1.setTargetValue(0.5f * wet * (1.0f + newParameters.width));
+    m_wetGain2.setTargetValue(0.5f * wet * (1.0f - newParameters.width));
+
+    m_gain = isFrozen(newParameters.freezeMode) ? 0.0f : 0.015f;
+    m_parameters = newParameters;
+    updateDamping();
+}
+
+void alex_dsp::Reverb::setNumActiveCombs(int numActive) noexcept
+{
+    numActive = juce::jlimit(1, numCombs, numActive);
+
+    if (numActive == m_numActiveCombs)
+        return;
+
+    for (int i = 0; i < numCombs; ++i)
+    {
+        const float target = i < numActive ? 1.0f : 0.0f;
+
+        // A line that had fully faded out stopped running; drop its stale tail
+        // before bringing it back.
+        if (target > 0.0f && m_combGains[i] == 0.0f && isPrepared())
+        {
+            for (int channel = 0; channel < maxChannels; ++channel)
+            {
+                juce::FloatVectorOperations::clear(m_combBuffers[channel][i], m_combSizes[channel][i]);
+                m_combStates[channel * numCombs + i] = { 0, 0.0f };
+            }
+        }
+
+        m_combGainTargets[i] = target;
+    }
+
+    m_numActiveCombs = numActive;
+    m_numProcessedCombs = juce::jmax(m_numProcessedCombs, numActive);
+    m_isFading = true;
+}
+
+void alex_dsp::Reverb::advanceCombFades() noexcept
+{
+    float totalGain = 0.0f;
+    bool isStillFading = false;
+
+    for (int i = 0; i < m_numProcessedCombs; ++i)
+    {
+        if (m_combGains[i] < m_combGainTargets[i])
+            m_combGains[i] = juce::jmin(m_combGainTargets[i], m_combGains[i] + m_combFadeStep);
+        else if (m_combGains[i] > m_combGainTargets[i])
+            m_combGains[i] = juce::jmax(m_combGainTargets[i], m_combGains[i] - m_combFadeStep);
+
+        isStillFading = isStillFading || m_combGains[i] != m_combGainTargets[i];
+        totalGain += m_combGains[i];
+    }
+
+    // The lines are roughly uncorrelated, so their sum grows with the square
+    // root of how many are running.
+    m_combCompensation = std::sqrt(static_cast<float> (numCombs) / juce::jmax(1.0f, totalGain));
+
+    if (! isStillFading)
+    {
+        m_numProcessedCombs = m_numActiveCombs;
+        m_isFading = false;
+    }
+}
+
+void alex_dsp::Reverb::updateDamping()
+{
+    const float roomScaleFactor = 0.28f;
+    const float roomOffset = 0.7f;
+    const float dampScaleFactor = 0.4f;
+
+    if (isFrozen(m_parameters.freezeMode))
+    {
+        m_damping.setTargetValue(0.0f);
+        m_feedback.setTargetValue(1.0f);
+    }
+    else
+    {
+        m_damping.setTargetValue(m_parameters.damping * dampScaleFactor);
+        m_feedback.setTargetValue(m_parameters.roomSize * roomScaleFactor + roomOffset);
+    }
+}
+
+float alex_dsp::Reverb::processComb(int channel, int comb, float input, float damp, float feedback) noexcept
+{
+    auto& state = m_combStates[channel * numCombs + comb];
+    auto* buffer = m_combBuffers[channel][comb];
+
+    const float output = buffer[state.index];
+    state.last = (output * (1.0f - damp)) + (state.last * damp);
+    JUCE_UNDENORMALISE(state.last);
+
+    float temp = input + (state.last * feedback);
+    JUCE_UNDENORMALISE(temp);
+    buffer[state.index] = temp;
+
+    if (++state.index >= m_combSizes[channel][comb])
+        state.index = 0;
+
+    return output;
+}
+
+float alex_dsp::Reverb::processAllPass(int channel, int allPass, float input) noexcept
+{
+    auto& state = m_allPassStates[channel * numAllPasses + allPass];
+    auto* buffer = m_allPassBuffers[channel][allPass];
+
+    const float bufferedValue = buffer[state.index];
+    float temp = input + (bufferedValue * 0.5f);
+    JUCE_UNDENORMALISE(temp);
+    buffer[state.index] = temp;
+
+    if (++state.index >= m_allPassSizes[channel][allPass])
+        state.index = 0;
+
+    return bufferedValue - input;
+}
+
+void alex_dsp::Reverb::processMono(float* samples, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float input = samples[i] * m_gain;
+        float output = 0.0f;
+
+        const float damp = m_damping.getNextValue();
+        const float feedback = m_feedback.getNextValue();
+
+        if (m_isFading)
+            advanceCombFades();
+
+        for (int j = 0; j < m_numProcessedCombs; ++j)
+            output += m_combGains[j] * processComb(0, j, input, damp, feedback);
+
+        output *= m_combCompensation;
+
+        for (int j = 0; j < numAllPasses; ++j)
+            output = processAllPass(0, j, output);
+
+        const float dry = m_dryGain.getNextValue();
+        const float wet1 = m_wetGain1.getNextValue();
+
+        samples[i] = output * wet1 + samples[i] * dry;
+    }
+}
+
+void alex_dsp::Reverb::processStereo(float* left, float* right, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float input = (left[i] + right[i]) * m_gain;
+        float outLeft = 0.0f;
+        float outRight = 0.0f;
+
+        const float damp = m_damping.getNextValue();
+        const float feedback = m_feedback.getNextValue();
+
+        if (m_isFading)
+            advanceCombFades();
+
+        for (int j = 0; j < m_numProcessedCombs; ++j)
+        {
+            outLeft += m_combGains[j] * processComb(0, j, input, damp, feedback);
+            outRight += m_combGains[j] * processComb(1, j, input, damp, feedback);
+        }
+
+        outLeft *= m_combCompensation;
+        outRight *= m_combCompensation;
+
+        for (int j = 0; j < numAllPasses; ++j)
+        {
+            outLeft = processAllPass(0, j, outLeft);
+            outRight = processAllPass(1, j, outRight);
+        }
+
+        const float dry = m_dryGain.getNextValue();
+        const float wet1 = m_wetGain1.getNextValue();
+        const float wet2 = m_wetGain2.getNextValue();
+
+        left[i] = outLeft * wet1 + outRight * wet2 + left[i] * dry;
+        right[i] = outRight * wet1 + outLeft * wet2 + right[i] * dry;
+    }
+}
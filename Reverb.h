@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    Reverb.h
+    Created: 19 Oct 2026 10:31:48am
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DSPArena.h"
+#include "SharedTables.h"
+
+namespace alex_dsp
+{
+/**
+    Freeverb, tuned and scaled exactly like juce::Reverb, but with its comb and
+    all-pass delay lines and their state living in a DSPArena instead of in
+    separate heap blocks. Line lengths come from the shared tables.
+
+    Call reserve() before the arena is allocated and attach() after it.
+*/
+class Reverb
+{
+public:
+    static constexpr int numCombs = SharedTables::numReverbCombs;
+    static constexpr int numAllPasses = SharedTables::numReverbAllPasses;
+    static constexpr int maxChannels = SharedTables::numReverbChannels;
+
+    Reverb();
+
+    void reserve(DSPArena& arena, const SharedTables& tables, const juce::dsp::ProcessSpec& spec);
+    void attach(DSPArena& arena);
+    void detach();
+
+    bool isPrepared() const noexcept { return m_combStates != nullptr; }
+
+    void reset();
+
+    void setParameters(const juce::Reverb::Parameters& newParameters);
+
+    /** Runs only the first numActive comb lines per channel, fading the others
+        in or out so the change doesn't click. Output level is compensated for
+        the missing lines. Safe to call from the audio thread. */
+    void setNumActiveCombs(int numActive) noexcept;
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = static_cast<int> (outputBlock.getNumSamples());
+
+        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (! isPrepared() || context.isBypassed)
+            return;
+
+        if (numChannels == 1)
+        {
+            processMono(outputBlock.getChannelPointer(0), numSamples);
+        }
+        else if (numChannels == 2)
+        {
+            processStereo(outputBlock.getChannelPointer(0), outputBlock.getChannelPointer(1), numSamples);
+        }
+        else
+        {
+            jassertfalse; // invalid channel configuration
+        }
+    };
+
+private:
+    struct CombState
+    {
+        int index;
+        float last;
+    };
+
+    struct AllPassState
+    {
+        int index;
+    };
+
+    void processMono(float* samples, int numSamples) noexcept;
+    void processStereo(float* left, float* right, int numSamples) noexcept;
+
+    float processComb(int channel, int comb, float input, float damp, float feedback) noexcept;
+    float processAllPass(int channel, int allPass, float input) noexcept;
+
+    void updateDamping();
+    void advanceCombFades() noexcept;
+
+    juce::Reverb::Parameters m_parameters;
+    float m_gain{ 0.015f };
+
+    juce::SmoothedValue<float> m_damping;
+    juce::SmoothedValue<float> m_feedback;
+    juce::SmoothedValue<float> m_dryGain;
+    juce::SmoothedValue<float> m_wetGain1;
+    juce::SmoothedValue<float> m_wetGain2;
+
+    float m_combGains[numCombs]{ 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    float m_combGainTargets[numCombs]{ 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    float m_combFadeStep{ 1.0f };
+    float m_combCompensation{ 1.0f };
+    int m_numActiveCombs{ numCombs };
+    int m_numProcessedCombs{ numCombs };
+    bool m_isFading{ false };
+
+    int m_combSizes[maxChannels][numCombs]{};
+    int m_allPassSizes[maxChannels][numAllPasses]{};
+
+    size_t m_combBufferOffsets[maxChannels][numCombs]{};
+    size_t m_allPassBufferOffsets[maxChannels][numAllPasses]{};
+    size_t m_combStateOffset{ 0 };
+    size_t m_allPassStateOffset{ 0 };
+
+    float* m_combBuffers[maxChannels][numCombs]{};
+    float* m_allPassBuffers[maxChannels][numAllPasses]{};
+    CombState* m_combStates{ nullptr };
+    AllPassState* m_allPassStates{ nullptr };
+};
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    SharedTables.cpp
+    Created: 19 Oct 2026 1:12:40pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "SharedTables.h"
+
+namespace
+{
+    // Freeverb tunings at 44.1kHz, identical to juce::Reverb.
+    constexpr int combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+    constexpr int allPassTunings[] = { 556, 441, 341, 225 };
+    constexpr int stereoSpread = 23;
+
+    constexpr double sincCutoff = 0.9;
+    constexpr double kaiserBeta = 8.0;
+
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+alex_dsp::SharedTables::SharedTables(double sampleRate)
+    : m_sampleRate(sampleRate)
+{
+    for (int i = 0; i <= wavetableSize; ++i)
+    {
+        const float phase = static_cast<float> (i) / wavetableSize;
+
+        m_wavetables[static_cast<size_t> (Wavetable::kTriangle)][i] = 2.0f * (phase < 0.5f ? phase : (1.0f - phase));
+        m_wavetables[static_cast<size_t> (Wavetable::kSine)][i] = 0.5f + 0.5f * std::sin(juce::MathConstants<float>::twoPi * phase);
+        m_wavetables[static_cast<size_t> (Wavetable::kSaw)][i] = phase;
+        m_wavetables[static_cast<size_t> (Wavetable::kSquare)][i] = phase < 0.5f ? 1.0f : 0.0f;
+    }
+
+    for (int i = 0; i <= saturationTableSize; ++i)
+    {
+        const float x = (2.0f * saturationRange * i) / saturationTableSize - saturationRange;
+        m_saturation[i] = std::tanh(x);
+    }
+
+    const double halfSpan = sincTaps / 2;
+
+    for (int band = 0; band < numSincBands; ++band)
+    {
+        const double cutoff = sincCutoff / (1.0 + band * sincBandWidth);
+
+        for (int phase = 0; phase <= sincPhases; ++phase)
+        {
+            const double fraction = static_cast<double> (phase) / sincPhases;
+            auto* row = m_sinc.data() + band * sincTableSize + phase * sincTaps;
+            double sum = 0.0;
+
+            for (int k = 0; k < sincTaps; ++k)
+            {
+                const double t = k - (sincTaps / 2 - 1) - fraction;
+                const double x = juce::MathConstants<double>::pi * cutoff * t;
+                const double sinc = t == 0.0 ? 1.0 : std::sin(x) / x;
+                const double window = besselI0(kaiserBeta * std::sqrt(juce::jmax(0.0, 1.0 - (t / halfSpan) * (t / halfSpan)))) / besselI0(kaiserBeta);
+
+                row[k] = static_cast<float> (sinc * window);
+                sum += row[k];
+            }
+
+            // Unity gain at DC for every phase.
+            for (int k = 0; k < sincTaps; ++k)
+                row[k] = static_cast<float> (row[k] / sum);
+        }
+    }
+
+    const auto intSampleRate = static_cast<int> (sampleRate);
+
+    for (int channel = 0; channel < numReverbChannels; ++channel)
+    {
+        const auto spread = channel * stereoSpread;
+
+        for (int i = 0; i < numReverbCombs; ++i)
+            m_combSizes[channel][i] = juce::jmax(1, (intSampleRate * (combTunings[i] + spread)) / 44100);
+
+        for (int i = 0; i < numReverbAllPasses; ++i)
+            m_allPassSizes[channel][i] = juce::jmax(1, (intSampleRate * (allPassTunings[i] + spread)) / 44100);
+    }
+}
+
+std::shared_ptr<const alex_dsp::SharedTables> alex_dsp::SharedTableRegistry::acquire(double sampleRate)
+{
+    static std::mutex lock;
+    static std::map<double, std::weak_ptr<const SharedTables>> tables;
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    for (auto it = tables.begin(); it != tables.end();)
+    {
+        if (it->second.expired())
+            it = tables.erase(it);
+        else
+            ++it;
+    }
+
+    if (auto existing = tables[sampleRate].lock())
+        return existing;
+
+    auto created = std::make_shared<const SharedTables>(sampleRate);
+    tables[sampleRate] = created;
+    return created;
+}
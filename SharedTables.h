@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    SharedTables.h
+    Created: 19 Oct 2026 1:12:40pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace alex_dsp
+{
+/**
+    Constant data every plugin instance needs at a given sample rate. Built
+    once, never modified afterwards, so any thread may read it without locking.
+*/
+class SharedTables
+{
+public:
+    static constexpr int wavetableSize = 2048;
+    static constexpr int saturationTableSize = 4096;
+    static constexpr float saturationRange = 8.0f;
+
+    static constexpr int numReverbChannels = 2;
+    static constexpr int numReverbCombs = 8;
+    static constexpr int numReverbAllPasses = 4;
+
+    static constexpr int sincTaps = 16;
+    static constexpr int sincPhases = 256;
+    static constexpr int numSincBands = 5;
+    static constexpr double sincBandWidth = 0.25;
+
+    enum class Wavetable
+    {
+        kTriangle,
+        kSine,
+        kSaw,
+        kSquare,
+        kNumWavetables
+    };
+
+    explicit SharedTables(double sampleRate);
+
+    double getSampleRate() const noexcept { return m_sampleRate; }
+
+    /** Unipolar (0 to 1) LFO shape, phase in [0, 1). */
+    float lookupWavetable(Wavetable shape, float phase) const noexcept
+    {
+        const auto* table = m_wavetables[static_cast<int> (shape)].data();
+        const float position = phase * wavetableSize;
+        const auto index = juce::jlimit(0, wavetableSize - 1, static_cast<int> (position));
+        const float fraction = position - index;
+
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+    /** tanh(x), clamped to +-1 outside the table range. */
+    float lookupSaturation(float x) const noexcept
+    {
+        if (x <= -saturationRange) return -1.0f;
+        if (x >= saturationRange) return 1.0f;
+
+        const float position = (x + saturationRange) * (saturationTableSize / (2.0f * saturationRange));
+        const auto index = juce::jmin(saturationTableSize - 1, static_cast<int> (position));
+        const float fraction = position - index;
+
+        return m_saturation[index] + fraction * (m_saturation[index + 1] - m_saturation[index]);
+    }
+
+    /** Freeverb delay line lengths in samples, scaled for this sample rate. */
+    int getCombSize(int channel, int comb) const noexcept { return m_combSizes[channel][comb]; }
+    int getAllPassSize(int channel, int allPass) const noexcept { return m_allPassSizes[channel][allPass]; }
+
+    /** Kaiser-windowed sinc, sincPhases + 1 rows of sincTaps coefficients.
+        Row p interpolates at fraction p / sincPhases, tap k sits at offset
+        k - (sincTaps / 2 - 1) from the integer read position.
+
+        Band b is for playback ratios up to 1 + b * sincBandWidth; its cutoff
+        is lowered by that ratio so reading faster than real time doesn't alias. */
+    const float* getSincTable(int band) const noexcept { return m_sinc.data() + band * sincTableSize; }
+
+    /** The narrowest band that still band-limits for the given playback ratio. */
+    static int getSincBand(double ratio) noexcept
+    {
+        return juce::jlimit(0, numSincBands - 1, static_cast<int> (std::ceil((ratio - 1.0) / sincBandWidth - 1.0e-9)));
+    }
+
+private:
+    double m_sampleRate;
+
+    std::array<std::array<float, wavetableSize + 1>, static_cast<size_t> (Wavetable::kNumWavetables)> m_wavetables;
+    std::array<float, saturationTableSize + 1> m_saturation;
+    static constexpr int sincTableSize = (sincPhases + 1) * sincTaps;
+
+    alignas (64) std::array<float, numSincBands * sincTableSize> m_sinc;
+
+    int m_combSizes[numReverbChannels][numReverbCombs];
+    int m_allPassSizes[numReverbChannels][numReverbAllPasses];
+
+    JUCE_DECLARE_NON_COPYABLE(SharedTables)
+};
+
+/**
+    Hands out one SharedTables per sample rate to every processor in the host
+    process. Tables are built on first request and freed when the last
+    instance holding them lets go.
+
+    acquire() takes a lock, so call it from prepareToPlay, never from the
+    audio thread; the returned tables themselves are lock-free to read.
+*/
+class SharedTableRegistry
+{
+public:
+    static std::shared_ptr<const SharedTables> acquire(double sampleRate);
+
+private:
+    SharedTableRegistry() = delete;
+};
+}
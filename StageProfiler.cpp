@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 19 Oct 2026 5:20:33pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+#if STUTTER_ENABLE_PROFILING
+
+namespace
+{
+    const char* const stageNames[] = { "Block", "Stutter", "Reverb", "Distortion", "LFO" };
+
+    std::atomic<int> nextTraceId{ 1 };
+
+    // Roughly 45 MB of JSON; after that only the histograms keep counting.
+    constexpr int maxTraceEvents = 500000;
+
+    // Shared by every instance so their tracks line up in the trace.
+    juce::int64 originTicks = juce::Time::getHighResolutionTicks();
+
+    double ticksToMicroseconds(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+    }
+}
+
+/** Owns the trace file and the drain thread. Lives while any profiler is
+    started, so a process gets one file however many instances it hosts.
+
+    The file uses the JSON array trace format, whose closing bracket the
+    trace viewers treat as optional, and is flushed after every pass, so a
+    host killed mid-session still leaves a loadable trace. */
+class alex_dsp::StageProfiler::TraceWriter : private juce::Thread
+{
+public:
+    TraceWriter()
+        : juce::Thread("StutterPlugin profiler")
+    {
+        const auto traceFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                   .getNonexistentChildFile("StutterPlugin", ".trace.json", false);
+
+        m_trace = std::make_unique<juce::FileOutputStream>(traceFile);
+
+        if (m_trace->openedOk())
+        {
+            *m_trace << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"StutterPlugin\"}}";
+            m_trace->flush();
+        }
+        else
+        {
+            m_trace.reset();
+        }
+
+        startThread();
+    }
+
+    ~TraceWriter() override
+    {
+        stopThread(1000);
+
+        if (m_trace == nullptr)
+            return;
+
+        *m_trace << "\n]\n";
+        m_trace->flush();
+    }
+
+    static std::shared_ptr<TraceWriter> acquire()
+    {
+        static std::mutex lock;
+        static std::weak_ptr<TraceWriter> writer;
+
+        const std::lock_guard<std::mutex> guard(lock);
+
+        if (auto existing = writer.lock())
+            return existing;
+
+        auto created = std::make_shared<TraceWriter>();
+        writer = created;
+        return created;
+    }
+
+    void add(StageProfiler& profiler)
+    {
+        const juce::ScopedLock lock(m_lock);
+        m_profilers.push_back(&profiler);
+
+        if (m_trace != nullptr)
+            *m_trace << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << profiler.m_traceId
+                     << ",\"args\":{\"name\":\"StutterPlugin #" << profiler.m_traceId << "\"}}";
+    }
+
+    void remove(StageProfiler& profiler)
+    {
+        const juce::ScopedLock lock(m_lock);
+        m_profilers.erase(std::remove(m_profilers.begin(), m_profilers.end(), &profiler), m_profilers.end());
+
+        drain(profiler);
+
+        if (m_trace == nullptr)
+            return;
+
+        // The histograms go in as an instant event on the instance's track,
+        // so they show up in the viewer's details pane.
+        *m_trace << ",\n{\"name\":\"stageStats\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"
+                 << juce::String(ticksToMicroseconds(juce::Time::getHighResolutionTicks() - originTicks), 3)
+                 << ",\"pid\":1,\"tid\":" << profiler.m_traceId << ",\"args\":";
+        profiler.writeStats(*m_trace);
+        *m_trace << "}";
+        m_trace->flush();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            {
+                const juce::ScopedLock lock(m_lock);
+
+                for (auto* profiler : m_profilers)
+                    drain(*profiler);
+
+                if (m_trace != nullptr)
+                    m_trace->flush();
+            }
+
+            wait(50);
+        }
+    }
+
+    void drain(StageProfiler& profiler)
+    {
+        const bool wasFull = m_numEvents >= maxTraceEvents;
+        m_numEvents += profiler.drain(m_trace.get(), maxTraceEvents - m_numEvents);
+
+        if (m_trace != nullptr && ! wasFull && m_numEvents >= maxTraceEvents)
+            *m_trace << ",\n{\"name\":\"trace full, stageStats keep counting\",\"ph\":\"i\",\"s\":\"g\",\"ts\":"
+                     << juce::String(ticksToMicroseconds(juce::Time::getHighResolutionTicks() - originTicks), 3)
+                     << ",\"pid\":1,\"tid\":0}";
+    }
+
+    juce::CriticalSection m_lock;
+    std::unique_ptr<juce::FileOutputStream> m_trace;
+    std::vector<StageProfiler*> m_profilers;
+    int m_numEvents{ 0 };
+};
+
+alex_dsp::StageProfiler::StageProfiler()
+    : m_ring(ringSize),
+      m_traceId(nextTraceId++)
+{
+}
+
+alex_dsp::StageProfiler::~StageProfiler()
+{
+    stop();
+}
+
+void alex_dsp::StageProfiler::start()
+{
+    if (m_writer != nullptr)
+        return;
+
+    m_writer = TraceWriter::acquire();
+    m_writer->add(*this);
+}
+
+void alex_dsp::StageProfiler::stop()
+{
+    if (m_writer == nullptr)
+        return;
+
+    m_writer->remove(*this);
+    m_writer.reset();
+}
+
+void alex_dsp::StageProfiler::record(Stage stage, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    int start1, size1, start2, size2;
+    m_fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+    {
+        ++m_numDropped;
+        return;
+    }
+
+    m_ring[static_cast<size_t> (size1 > 0 ? start1 : start2)] = { stage, startTicks, endTicks };
+    m_fifo.finishedWrite(1);
+}
+
+alex_dsp::StageProfiler::Stats alex_dsp::StageProfiler::getStats(Stage stage) const
+{
+    const juce::ScopedLock lock(m_statsLock);
+    const auto& histogram = m_histograms[static_cast<int> (stage)];
+
+    if (histogram.count == 0)
+        return { 0, 0.0, 0.0, 0.0 };
+
+    const auto p99Count = static_cast<juce::int64> (std::ceil(0.99 * histogram.count));
+    juce::int64 seen = 0;
+    int p99Bucket = numBuckets - 1;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        seen += histogram.buckets[i];
+
+        if (seen >= p99Count)
+        {
+            p99Bucket = i;
+            break;
+        }
+    }
+
+    // Report the bucket's upper edge, so p99 is never understated.
+    const double p99Nanoseconds = std::pow(2.0, static_cast<double> (p99Bucket + 1) / bucketsPerOctave);
+
+    return { histogram.count,
+             histogram.minNanoseconds * 1.0e-3,
+             histogram.totalNanoseconds / histogram.count * 1.0e-3,
+             p99Nanoseconds * 1.0e-3 };
+}
+
+int alex_dsp::StageProfiler::drain(juce::OutputStream* trace, int maxEvents)
+{
+    int start1, size1, start2, size2;
+    m_fifo.prepareToRead(m_fifo.getNumReady(), start1, size1, start2, size2);
+
+    const juce::ScopedLock lock(m_statsLock);
+
+    int numWritten = 0;
+
+    auto consume = [this, trace, maxEvents, &numWritten](int start, int size)
+    {
+        for (int i = start; i < start + size; ++i)
+        {
+            const auto& sample = m_ring[static_cast<size_t> (i)];
+            const double startMicroseconds = ticksToMicroseconds(sample.startTicks - originTicks);
+            const double durationMicroseconds = ticksToMicroseconds(sample.endTicks - sample.startTicks);
+
+            if (trace != nullptr && numWritten < maxEvents)
+            {
+                ++numWritten;
+                *trace << ",\n{\"name\":\"" << stageNames[static_cast<int> (sample.stage)]
+                       << "\",\"cat\":\"dsp\",\"ph\":\"X\",\"ts\":" << juce::String(startMicroseconds, 3)
+                       << ",\"dur\":" << juce::String(durationMicroseconds, 3)
+                       << ",\"pid\":1,\"tid\":" << m_traceId << "}";
+            }
+
+            auto& histogram = m_histograms[static_cast<int> (sample.stage)];
+            const double nanoseconds = durationMicroseconds * 1.0e3;
+            const auto bucket = nanoseconds <= 1.0 ? 0
+                                                   : juce::jlimit(0, numBuckets - 1, static_cast<int> (std::log2(nanoseconds) * bucketsPerOctave));
+
+            histogram.minNanoseconds = histogram.count == 0 ? nanoseconds : juce::jmin(histogram.minNanoseconds, nanoseconds);
+            histogram.totalNanoseconds += nanoseconds;
+            ++histogram.buckets[bucket];
+            ++histogram.count;
+        }
+    };
+
+    consume(start1, size1);
+    consume(start2, size2);
+
+    m_fifo.finishedRead(size1 + size2);
+    return numWritten;
+}
+
+void alex_dsp::StageProfiler::writeStats(juce::OutputStream& stream) const
+{
+    stream << "{";
+
+    for (int i = 0; i < static_cast<int> (Stage::kNumStages); ++i)
+    {
+        const auto stats = getStats(static_cast<Stage> (i));
+
+        stream << (i == 0 ? "\n" : ",\n")
+               << "\"" << stageNames[i] << "\":{\"count\":" << stats.count
+               << ",\"minUs\":" << juce::String(stats.minMicroseconds, 3)
+               << ",\"avgUs\":" << juce::String(stats.averageMicroseconds, 3)
+               << ",\"p99Us\":" << juce::String(stats.p99Microseconds, 3) << "}";
+    }
+
+    stream << ",\n\"droppedSamples\":" << m_numDropped.load() << "\n}";
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026 5:20:33pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/** Set to 1 to time every processBlock stage and write a Chrome/Perfetto trace.
+    When 0 the profiler and everything using it compiles away. */
+#ifndef STUTTER_ENABLE_PROFILING
+ #define STUTTER_ENABLE_PROFILING 0
+#endif
+
+#if STUTTER_ENABLE_PROFILING
+
+namespace alex_dsp
+{
+/**
+    Timestamps processBlock stages on the audio thread and pushes them through
+    a lock-free single-producer ring, one per instance. A single background
+    thread shared by every instance in the process drains all the rings into
+    one Chrome trace JSON file in the temp directory (open it in
+    chrome://tracing or ui.perfetto.dev), one track per instance, and keeps
+    per-stage duration histograms. The trace stops taking events after a
+    fixed cap so long sessions can't fill the disk; the histograms keep
+    counting and are added to the trace when each instance stops.
+
+    Instances that are never started (e.g. a host scanning the plugin) cost
+    nothing beyond their ring.
+*/
+class StageProfiler
+{
+public:
+    enum class Stage
+    {
+        kBlock,
+        kStutter,
+        kReverb,
+        kDistortion,
+        kLFO,
+        kNumStages
+    };
+
+    struct Stats
+    {
+        juce::int64 count;
+        double minMicroseconds;
+        double averageMicroseconds;
+        double p99Microseconds;
+    };
+
+    StageProfiler();
+    ~StageProfiler();
+
+    /** Joins the shared trace, opening it if this is the first instance.
+        Does nothing if already started. Call from the message thread. */
+    void start();
+
+    /** Drains what is left and records the histograms in the trace; the last
+        instance to stop closes the file. */
+    void stop();
+
+    /** Audio thread. Never blocks; samples are dropped if the ring is full. */
+    void record(Stage stage, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    Stats getStats(Stage stage) const;
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(StageProfiler& profiler, Stage stage) noexcept
+            : m_profiler(profiler), m_stage(stage), m_startTicks(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedStage() { m_profiler.record(m_stage, m_startTicks, juce::Time::getHighResolutionTicks()); }
+
+    private:
+        StageProfiler& m_profiler;
+        Stage m_stage;
+        juce::int64 m_startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+private:
+    class TraceWriter;
+
+    static constexpr int ringSize = 8192;
+
+    // Log-spaced duration buckets, 8 per octave of nanoseconds.
+    static constexpr int bucketsPerOctave = 8;
+    static constexpr int numBuckets = 32 * bucketsPerOctave;
+
+    struct Sample
+    {
+        Stage stage;
+        juce::int64 startTicks;
+        juce::int64 endTicks;
+    };
+
+    struct Histogram
+    {
+        juce::int64 count = 0;
+        double totalNanoseconds = 0.0;
+        double minNanoseconds = 0.0;
+        juce::int64 buckets[numBuckets] = {};
+    };
+
+    /** Called by the TraceWriter with its lock held. Writes at most maxEvents
+        events and returns how many it wrote; trace may be null if the file
+        couldn't be opened. The histograms see every sample either way. */
+    int drain(juce::OutputStream* trace, int maxEvents);
+    void writeStats(juce::OutputStream& stream) const;
+
+    juce::AbstractFifo m_fifo{ ringSize };
+    std::vector<Sample> m_ring;
+    std::atomic<juce::int64> m_numDropped{ 0 };
+
+    std::shared_ptr<TraceWriter> m_writer;
+    int m_traceId{ 0 };
+
+    juce::CriticalSection m_statsLock;
+    Histogram m_histograms[static_cast<int> (Stage::kNumStages)];
+};
+}
+
+ #define STUTTER_PROFILE_STAGE(profiler, stage) \
+    const alex_dsp::StageProfiler::ScopedStage JUCE_JOIN_MACRO(profiledStage_, __LINE__) (profiler, alex_dsp::StageProfiler::Stage::stage)
+
+#else
+
+ #define STUTTER_PROFILE_STAGE(profiler, stage)
+
+#endif
@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+    Stutter.cpp
+    Created: 19 Oct 2026 7:48:19pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#include "Stutter.h"
+
+namespace
+{
+    constexpr double modeFadeTime = 0.005;
+    constexpr double minRatio = 0.25;
+    constexpr double maxRatio = 2.0;
+    constexpr int minSliceLength = 64;
+
+    // Fade at either end of a repeated slice so the loop point doesn't click.
+    constexpr double sliceEdgeFadeTime = 0.002;
+
+    // 24 of the 32 fraction bits, so the float can never round up to 1.0.
+    constexpr float fractionScale = 1.0f / 16777216.0f;
+
+    // How far behind the write head reads start, so the sinc kernel never
+    // reads samples that haven't been captured yet.
+    int liveMargin() noexcept
+    {
+        return alex_dsp::Resampler::getRightReach(alex_dsp::Resampler::Quality::kSinc) + 1;
+    }
+
+    bool readsFrozenSlice(alex_dsp::Stutter::Mode mode) noexcept
+    {
+        return mode == alex_dsp::Stutter::Mode::kRepeat || mode == alex_dsp::Stutter::Mode::kReverse;
+    }
+}
+
+void alex_dsp::Stutter::reserve(DSPArena& arena, const SharedTables& tables, const juce::dsp::ProcessSpec& spec)
+{
+    detach();
+
+    m_tables = &tables;
+    m_sampleRate = spec.sampleRate;
+    m_maxBlockSize = juce::jmax(1, static_cast<int> (spec.maximumBlockSize));
+    m_numChannels = juce::jlimit(1, maxChannels, static_cast<int> (spec.numChannels));
+
+    // Repeat and reverse stop capturing, and tape modes never fall more than
+    // half a slice behind while audible, so one slice plus the read margins
+    // is all the history ever needed.
+    const auto maxSliceLength = static_cast<int> (std::ceil(maxSliceBeats * 60.0 / minTempo * spec.sampleRate));
+    m_ringSize = juce::nextPowerOfTwo(maxSliceLength + liveMargin() + Resampler::getLeftReach(Resampler::Quality::kSinc));
+    m_ringMask = m_ringSize - 1;
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+        m_ringOffsets[channel] = arena.reserve<float>(static_cast<size_t> (m_ringSize + Resampler::guardSamples));
+
+    const auto blockSize = static_cast<size_t> (m_maxBlockSize);
+    m_indexOffset = arena.reserve<int>(blockSize);
+    m_fractionOffset = arena.reserve<float>(blockSize);
+    m_gainOffset = arena.reserve<float>(blockSize);
+    m_mixOffset = arena.reserve<float>(blockSize);
+    m_scratchOffset = arena.reserve<float>(2 * maxChannels * blockSize);
+
+    m_wetGain.reset(spec.sampleRate, modeFadeTime);
+}
+
+void alex_dsp::Stutter::attach(DSPArena& arena)
+{
+    for (int channel = 0; channel < m_numChannels; ++channel)
+        m_rings[channel] = arena.get<float>(m_ringOffsets[channel]);
+
+    m_indices = arena.get<int>(m_indexOffset);
+    m_fractions = arena.get<float>(m_fractionOffset);
+    m_gains = arena.get<float>(m_gainOffset);
+    m_mix = arena.get<float>(m_mixOffset);
+    auto* scratch = arena.get<float>(m_scratchOffset);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        m_wet[channel] = scratch + channel * m_maxBlockSize;
+        m_previousWet[channel] = scratch + (maxChannels + channel) * m_maxBlockSize;
+    }
+
+    // The arena comes back zeroed, so only the state needs resetting.
+    resetState();
+}
+
+void alex_dsp::Stutter::detach()
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+        m_rings[channel] = nullptr;
+
+    m_indices = nullptr;
+    m_fractions = nullptr;
+    m_gains = nullptr;
+    m_mix = nullptr;
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        m_wet[channel] = nullptr;
+        m_previousWet[channel] = nullptr;
+    }
+}
+
+void alex_dsp::Stutter::reset()
+{
+    if (! isPrepared()) return;
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+        juce::FloatVectorOperations::clear(m_rings[channel], m_ringSize + Resampler::guardSamples);
+
+    resetState();
+}
+
+void alex_dsp::Stutter::resetState() noexcept
+{
+    m_writeIndex = 0;
+    m_activeMode = Mode::kOff;
+    m_activeQuality = static_cast<Resampler::Quality>(juce::jmin(m_quality.load(), m_maxQuality.load()));
+    m_wetGain.setCurrentAndTargetValue(0.0f);
+    m_currentRatio = 1.0;
+}
+
+void alex_dsp::Stutter::setParameter(ParameterId parameter, float parameterValue)
+{
+    switch (parameter)
+    {
+    case alex_dsp::Stutter::ParameterId::kMode: m_requestedMode = juce::jlimit(0, static_cast<int>(Mode::kReverse), static_cast<int>(parameterValue)); break;
+    case alex_dsp::Stutter::ParameterId::kDivision: m_division = parameterValue; break;
+    case alex_dsp::Stutter::ParameterId::kPitch: m_pitch = parameterValue; break;
+    case alex_dsp::Stutter::ParameterId::kPitchModulation: m_pitchModulation = parameterValue; break;
+    case alex_dsp::Stutter::ParameterId::kTempo: m_tempo = parameterValue; break;
+    case alex_dsp::Stutter::ParameterId::kQuality: m_quality = juce::jlimit(0, static_cast<int>(Resampler::Quality::kSinc), static_cast<int>(parameterValue)); break;
+    case alex_dsp::Stutter::ParameterId::kMaxQuality: m_maxQuality = juce::jlimit(0, static_cast<int>(Resampler::Quality::kSinc), static_cast<int>(parameterValue)); break;
+    }
+}
+
+void alex_dsp::Stutter::processChunk(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const auto requestedMode = static_cast<Mode>(m_requestedMode.load());
+
+    // Only swap modes once the wet signal has faded out, so the jump in read
+    // position is never heard.
+    if (requestedMode != m_activeMode)
+    {
+        if (m_wetGain.getCurrentValue() == 0.0f)
+        {
+            trigger(requestedMode);
+            m_wetGain.setTargetValue(requestedMode == Mode::kOff ? 0.0f : 1.0f);
+        }
+        else
+        {
+            m_wetGain.setTargetValue(0.0f);
+        }
+    }
+    else
+    {
+        // The request may have come back before the fade out finished.
+        m_wetGain.setTargetValue(m_activeMode == Mode::kOff ? 0.0f : 1.0f);
+    }
+
+    if (! readsFrozenSlice(m_activeMode))
+        capture(channels, numChannels, numSamples);
+
+    const auto quality = static_cast<Resampler::Quality>(juce::jmin(m_quality.load(), m_maxQuality.load()));
+
+    if (m_activeMode == Mode::kOff)
+    {
+        m_activeQuality = quality;
+        m_activeSincBand = m_sincBand;
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        m_mix[i] = m_wetGain.getNextValue();
+
+    const double semitones = m_pitch.load() + m_pitchModulation;
+    computeReadPositions(numSamples, juce::jlimit(minRatio, maxRatio, std::pow(2.0, semitones / 12.0)));
+
+    // Switching sinc bands changes the kernel as much as switching quality.
+    const bool isChangingQuality = quality != m_activeQuality
+                                || (quality == Resampler::Quality::kSinc && m_sincBand != m_activeSincBand);
+
+    Resampler::process(quality, *m_tables, m_sincBand, m_rings, numChannels, m_ringMask, m_indices, m_fractions, m_wet, numSamples);
+
+    // Crossfade from the old kernel over one block.
+    if (isChangingQuality)
+        Resampler::process(m_activeQuality, *m_tables, m_activeSincBand, m_rings, numChannels, m_ringMask, m_indices, m_fractions, m_previousWet, numSamples);
+
+    const float step = 1.0f / numSamples;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* samples = channels[channel];
+        auto* wet = m_wet[channel];
+
+        if (isChangingQuality)
+        {
+            const auto* previousWet = m_previousWet[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+                wet[i] = previousWet[i] + (i + 1) * step * (wet[i] - previousWet[i]);
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] += m_mix[i] * (m_gains[i] * wet[i] - samples[i]);
+    }
+
+    m_activeQuality = quality;
+    m_activeSincBand = m_sincBand;
+}
+
+void alex_dsp::Stutter::capture(const float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const int firstPart = juce::jmin(numSamples, m_ringSize - m_writeIndex);
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+    {
+        // A mono input feeds every ring.
+        const auto* source = channels[juce::jmin(channel, numChannels - 1)];
+        auto* ring = m_rings[channel];
+
+        juce::FloatVectorOperations::copy(ring + m_writeIndex, source, firstPart);
+        juce::FloatVectorOperations::copy(ring, source + firstPart, numSamples - firstPart);
+
+        // Mirror the start of the ring past its end for the interpolators.
+        juce::FloatVectorOperations::copy(ring + m_ringSize, ring, Resampler::guardSamples);
+    }
+
+    m_writeIndex = (m_writeIndex + numSamples) & m_ringMask;
+}
+
+void alex_dsp::Stutter::trigger(Mode mode) noexcept
+{
+    m_activeMode = mode;
+    m_currentRatio = juce::jlimit(minRatio, maxRatio, std::pow(2.0, (m_pitch.load() + m_pitchModulation) / 12.0));
+
+    // Leave room for the margin and the kernel's left reach, so the oldest
+    // sample a slice reads hasn't been overwritten.
+    const int margin = liveMargin();
+    const int maxSliceLength = m_ringSize - margin - Resampler::getLeftReach(Resampler::Quality::kSinc);
+
+    const double secondsPerBeat = 60.0 / juce::jmax(1.0f, m_tempo.load());
+    const auto sliceLength = juce::jlimit(minSliceLength, maxSliceLength,
+                                          juce::roundToInt(m_division.load() * secondsPerBeat * m_sampleRate));
+
+    const auto liveStart = static_cast<juce::uint64> ((m_writeIndex - margin) & m_ringMask) << 32;
+
+    switch (mode)
+    {
+    case Mode::kOff:
+        break;
+    case Mode::kRepeat:
+    case Mode::kReverse:
+        m_sliceStart = static_cast<juce::uint32> ((m_writeIndex - sliceLength - margin) & m_ringMask);
+        m_sliceLength = sliceLength * fixedOne;
+        m_slicePosition = mode == Mode::kRepeat ? 0 : m_sliceLength - 1;
+        break;
+    case Mode::kTapeStop:
+        m_readPosition = liveStart;
+        m_increment = fixedOne;
+        m_incrementStep = -fixedOne / sliceLength;
+        break;
+    case Mode::kTapeStart:
+        m_readPosition = liveStart;
+        m_increment = 0;
+        m_incrementStep = fixedOne / sliceLength;
+        break;
+    }
+}
+
+void alex_dsp::Stutter::computeReadPositions(int numSamples, double targetRatio) noexcept
+{
+    if (readsFrozenSlice(m_activeMode))
+    {
+        // Ramp the speed across the block in whole fixed-point steps; the
+        // position is a sum of integers, so it lands exactly where it should.
+        const double direction = m_activeMode == Mode::kReverse ? -1.0 : 1.0;
+        auto increment = static_cast<juce::int64> (std::llround(direction * m_currentRatio * fixedOne));
+        const auto incrementEnd = static_cast<juce::int64> (std::llround(direction * targetRatio * fixedOne));
+        const auto incrementStep = (incrementEnd - increment) / numSamples;
+        const auto sliceStart = static_cast<juce::uint64> (m_sliceStart) << 32;
+
+        // Band-limit for the fastest speed reached in this block.
+        m_sincBand = SharedTables::getSincBand(juce::jmax(m_currentRatio, targetRatio));
+
+        const auto edgeFade = static_cast<juce::int64> (juce::jmin(sliceEdgeFadeTime * m_sampleRate, m_sliceLength / (4.0 * fixedOne)) * fixedOne);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            storeReadPosition(i, sliceStart + static_cast<juce::uint64> (m_slicePosition));
+
+            const auto distanceToEdge = juce::jmin(m_slicePosition, m_sliceLength - m_slicePosition);
+            m_gains[i] = distanceToEdge >= edgeFade ? 1.0f : static_cast<float> (distanceToEdge) / static_cast<float> (edgeFade);
+
+            m_slicePosition += increment;
+            increment += incrementStep;
+
+            if (m_slicePosition >= m_sliceLength)
+                m_slicePosition -= m_sliceLength;
+            else if (m_slicePosition < 0)
+                m_slicePosition += m_sliceLength;
+        }
+
+        m_currentRatio = targetRatio;
+    }
+    else
+    {
+        // Tape modes follow their own speed ramp; the level follows the speed
+        // so a stopped tape is silent rather than a held sample. They never
+        // play faster than real time, so the full-band kernel is fine.
+        m_sincBand = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            storeReadPosition(i, m_readPosition);
+            m_gains[i] = static_cast<float> (m_increment) / static_cast<float> (fixedOne);
+
+            m_readPosition += static_cast<juce::uint64> (m_increment);
+            m_increment = juce::jlimit(static_cast<juce::int64> (0), fixedOne, m_increment + m_incrementStep);
+        }
+    }
+}
+
+void alex_dsp::Stutter::storeReadPosition(int sample, juce::uint64 position) noexcept
+{
+    m_indices[sample] = static_cast<int> ((position >> 32) & static_cast<juce::uint64> (m_ringMask));
+    m_fractions[sample] = static_cast<float> ((position & 0xffffffffu) >> 8) * fractionScale;
+}
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    Stutter.h
+    Created: 19 Oct 2026 7:48:19pm
+    Author:  goupy
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DSPArena.h"
+#include "SharedTables.h"
+#include "Resampler.h"
+
+namespace alex_dsp
+{
+/**
+    Captures the input into a ring buffer and replays it at varying speed:
+    pitched repeats of the last slice, reversed slices, and tape-stop /
+    tape-start ramps. Slice length follows the host tempo; pitch can be
+    modulated block by block (e.g. from an LFOGenerator).
+
+    The read pointer is 32.32 fixed point and only ever advanced by integer
+    increments, so it cannot drift however long a slice repeats. Mode changes
+    fade the wet signal out and back in.
+
+    Call reserve() before the arena is allocated and attach() after it.
+*/
+class Stutter
+{
+public:
+    static constexpr int maxChannels = 2;
+    /** The ring is sized for the longest slice, maxSliceBeats at minTempo.
+        Slower tempos get the longest slice that still fits. */
+    static constexpr double maxSliceBeats = 1.0;
+    static constexpr double minTempo = 60.0;
+
+    enum class Mode
+    {
+        kOff,
+        kRepeat,
+        kTapeStop,
+        kTapeStart,
+        kReverse
+    };
+
+    enum class ParameterId
+    {
+        kMode,
+        kDivision,
+        kPitch,
+        kPitchModulation,
+        kTempo,
+        kQuality,
+        kMaxQuality,
+    };
+
+    void reserve(DSPArena& arena, const SharedTables& tables, const juce::dsp::ProcessSpec& spec);
+    void attach(DSPArena& arena);
+    void detach();
+
+    bool isPrepared() const noexcept { return m_indices != nullptr; }
+
+    /** Clears the capture and returns to kOff. attach() doesn't need it, the
+        arena is already zeroed. */
+    void reset();
+
+    /** kDivision is the slice length in beats, kPitch and kPitchModulation are
+        in semitones, kQuality and kMaxQuality take a Resampler::Quality. */
+    void setParameter(ParameterId parameter, float parameterValue);
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = juce::jmin(static_cast<int> (outputBlock.getNumChannels()), m_numChannels);
+        const auto numSamples = static_cast<int> (outputBlock.getNumSamples());
+
+        jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert(inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (! isPrepared() || context.isBypassed || numChannels == 0)
+            return;
+
+        float* channels[maxChannels] = {};
+
+        for (int start = 0; start < numSamples; start += m_maxBlockSize)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                channels[channel] = outputBlock.getChannelPointer(static_cast<size_t> (channel)) + start;
+
+            processChunk(channels, numChannels, juce::jmin(m_maxBlockSize, numSamples - start));
+        }
+    };
+
+private:
+    static constexpr juce::int64 fixedOne = static_cast<juce::int64> (1) << 32;
+
+    void processChunk(float* const* channels, int numChannels, int numSamples) noexcept;
+    void capture(const float* const* channels, int numChannels, int numSamples) noexcept;
+    void resetState() noexcept;
+    void trigger(Mode mode) noexcept;
+    void computeReadPositions(int numSamples, double targetRatio) noexcept;
+    void storeReadPosition(int sample, juce::uint64 position) noexcept;
+
+    const SharedTables* m_tables{ nullptr };
+    double m_sampleRate{ 44100.0 };
+    int m_maxBlockSize{ 0 };
+    int m_numChannels{ 0 };
+
+    int m_ringSize{ 0 };
+    int m_ringMask{ 0 };
+    int m_writeIndex{ 0 };
+
+    size_t m_ringOffsets[maxChannels]{};
+    size_t m_indexOffset{ 0 };
+    size_t m_fractionOffset{ 0 };
+    size_t m_gainOffset{ 0 };
+    size_t m_mixOffset{ 0 };
+    size_t m_scratchOffset{ 0 };
+
+    float* m_rings[maxChannels]{};
+    int* m_indices{ nullptr };
+    float* m_fractions{ nullptr };
+    float* m_gains{ nullptr };
+    float* m_mix{ nullptr };
+    float* m_wet[maxChannels]{};
+    float* m_previousWet[maxChannels]{};
+
+    std::atomic<int> m_requestedMode{ static_cast<int> (Mode::kOff) };
+    std::atomic<float> m_division{ 0.25f };
+    std::atomic<float> m_pitch{ 0.0f };
+    std::atomic<float> m_tempo{ 120.0f };
+    std::atomic<int> m_quality{ static_cast<int> (Resampler::Quality::kSinc) };
+    std::atomic<int> m_maxQuality{ static_cast<int> (Resampler::Quality::kSinc) };
+    float m_pitchModulation{ 0.0f };
+
+    Mode m_activeMode{ Mode::kOff };
+    Resampler::Quality m_activeQuality{ Resampler::Quality::kSinc };
+    int m_sincBand{ 0 };
+    int m_activeSincBand{ 0 };
+    juce::SmoothedValue<float> m_wetGain;
+
+    // Repeat and reverse: position inside the frozen slice. Tape modes:
+    // absolute ring position. Both 32.32 fixed point.
+    juce::uint32 m_sliceStart{ 0 };
+    juce::int64 m_sliceLength{ 0 };
+    juce::int64 m_slicePosition{ 0 };
+    juce::uint64 m_readPosition{ 0 };
+    juce::int64 m_increment{ 0 };
+    juce::int64 m_incrementStep{ 0 };
+    double m_currentRatio{ 1.0 };
+};
+}